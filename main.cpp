@@ -6,24 +6,418 @@
 #include <numeric>
 #include <queue>
 #include <algorithm>
+#include <list>
+#include <unordered_map>
+#include <set>
 
 using namespace std;
 
+// 连通分量计数缓存：键为分量的节点集合及各节点的可用颜色，按LRU淘汰，占用内存有上限
+struct ComponentCache {
+    size_t capacity; // 内存上限（字节）
+    size_t used = 0; // 当前占用（字节）
+    list<pair<string, long double>> entries; // 按最近使用排序，表头为最新
+    unordered_map<string, list<pair<string, long double>>::iterator> index;
+
+    ComponentCache(size_t bytes) : capacity(bytes) {}
+
+    // 估算一条记录的内存：键在链表和哈希表中各存一份，另加节点开销
+    static size_t entrySize(const string& key) {
+        return 2 * key.size() + 96;
+    }
+
+    bool get(const string& key, long double& value) {
+        auto it = index.find(key);
+        if (it == index.end()) return false;
+        entries.splice(entries.begin(), entries, it->second);
+        value = it->second->second;
+        return true;
+    }
+
+    void put(const string& key, long double value) {
+        if (index.count(key)) return;
+        entries.emplace_front(key, value);
+        index[key] = entries.begin();
+        used += entrySize(key);
+        while (used > capacity && entries.size() > 1) {
+            used -= entrySize(entries.back().first);
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+};
+
+// 可用颜色表：所有节点的行连续存放在同一块内存中，每行第0列为剩余可用颜色数，第c列为1表示颜色c已被邻居占用
+struct ColorTable {
+    int width = 0; // 每行的列数，即最大颜色数+1
+    vector<int> cells;
+
+    ColorTable() {}
+    ColorTable(int rows, int w) : width(w), cells(rows * w, 0) {}
+
+    int* operator[](int row) { return cells.data() + row * width; }
+    const int* operator[](int row) const { return cells.data() + row * width; }
+};
+
+// 简化版CDCL求解器：两文字监视、1UIP冲突学习与非时序回跳、VSIDS变量活跃度、相位保存、Luby重启
+// 文字编码：变量v（从0开始）的正文字为2v，负文字为2v+1
+struct SatSolver {
+    int numVars;
+    bool unsat = false; // 添加子句时已发现矛盾
+    vector<vector<int>> clauses; // 原始子句和学习子句
+    vector<vector<int>> watches; // watches[lit]：监视lit的子句编号，lit变假时检查
+    vector<int> assigns; // 每个变量的取值：1真，-1假，0未赋值
+    vector<int> level; // 变量被赋值时的决策层
+    vector<int> reason; // 蕴含该变量的子句编号，决策变量为-1
+    vector<int> trail; // 按赋值顺序记录的真文字
+    vector<int> trailLim; // 每个决策层在trail中的起点
+    int qhead = 0; // 下一个待传播的trail位置
+    vector<double> activity; // VSIDS活跃度
+    double varInc = 1;
+    vector<char> phase; // 上次的取值，重新决策时沿用
+    vector<char> seen; // 冲突分析时的标记
+    vector<int> heap; // 按活跃度排列的最大堆
+    vector<int> heapPos; // 变量在堆中的位置，-1表示不在堆中
+    vector<char> learntFlag; // 子句是否为学习子句
+    vector<double> clauseActivity; // 学习子句的活跃度，删减时保留活跃的一半
+    double claInc = 1;
+    vector<int> freeSlots; // 已删除学习子句空出的编号，可复用
+    int numLearnts = 0; // 当前学习子句数
+
+    SatSolver(int n) : numVars(n), watches(2 * n), assigns(n, 0), level(n, 0), reason(n, -1), activity(n, 0), phase(n, 0), seen(n, 0), heapPos(n, -1) {
+        for (int v = 0; v < n; v++) heapInsert(v);
+    }
+
+    int value(int lit) const {
+        int val = assigns[lit >> 1];
+        return (lit & 1) ? -val : val;
+    }
+
+    int decisionLevel() const { return trailLim.size(); }
+
+    bool heapLess(int a, int b) const { return activity[heap[a]] > activity[heap[b]]; }
+
+    void heapSwap(int a, int b) {
+        swap(heap[a], heap[b]);
+        heapPos[heap[a]] = a;
+        heapPos[heap[b]] = b;
+    }
+
+    void heapUp(int i) {
+        while (i > 0 && heapLess(i, (i - 1) / 2)) {
+            heapSwap(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+
+    void heapDown(int i) {
+        while (true) {
+            int best = i, l = 2 * i + 1, r = 2 * i + 2;
+            if (l < (int)heap.size() && heapLess(l, best)) best = l;
+            if (r < (int)heap.size() && heapLess(r, best)) best = r;
+            if (best == i) return;
+            heapSwap(i, best);
+            i = best;
+        }
+    }
+
+    void heapInsert(int v) {
+        if (heapPos[v] != -1) return;
+        heapPos[v] = heap.size();
+        heap.push_back(v);
+        heapUp(heapPos[v]);
+    }
+
+    int heapPop() {
+        int v = heap[0];
+        heapSwap(0, heap.size() - 1);
+        heap.pop_back();
+        heapPos[v] = -1;
+        if (!heap.empty()) heapDown(0);
+        return v;
+    }
+
+    void bumpVar(int v) {
+        activity[v] += varInc;
+        if (activity[v] > 1e100) {
+            for (double& a : activity) a *= 1e-100;
+            varInc *= 1e-100;
+        }
+        if (heapPos[v] != -1) heapUp(heapPos[v]);
+    }
+
+    void enqueue(int lit, int from) {
+        int v = lit >> 1;
+        assigns[v] = (lit & 1) ? -1 : 1;
+        level[v] = decisionLevel();
+        reason[v] = from;
+        trail.push_back(lit);
+    }
+
+    void cancelUntil(int lvl) {
+        if (decisionLevel() <= lvl) return;
+        for (int i = (int)trail.size() - 1; i >= trailLim[lvl]; i--) {
+            int v = trail[i] >> 1;
+            phase[v] = assigns[v] > 0;
+            assigns[v] = 0;
+            reason[v] = -1;
+            heapInsert(v);
+        }
+        trail.resize(trailLim[lvl]);
+        trailLim.resize(lvl);
+        qhead = trail.size();
+    }
+
+    void addClause(vector<int> lits) {
+        if (unsat) return;
+        sort(lits.begin(), lits.end());
+        lits.erase(unique(lits.begin(), lits.end()), lits.end());
+        for (size_t i = 0; i + 1 < lits.size(); i++) {
+            if ((lits[i] ^ 1) == lits[i + 1]) return; // 恒真子句
+        }
+        if (lits.empty()) {
+            unsat = true;
+        } else if (lits.size() == 1) {
+            if (value(lits[0]) == -1) unsat = true;
+            else if (value(lits[0]) == 0) enqueue(lits[0], -1);
+        } else {
+            watches[lits[0]].push_back(clauses.size());
+            watches[lits[1]].push_back(clauses.size());
+            clauses.push_back(lits);
+            learntFlag.push_back(0);
+            clauseActivity.push_back(0);
+        }
+    }
+
+    // 保存学习子句并监视前两个文字，返回子句编号
+    int addLearnt(const vector<int>& lits) {
+        int ci;
+        if (!freeSlots.empty()) {
+            ci = freeSlots.back();
+            freeSlots.pop_back();
+            clauses[ci] = lits;
+        } else {
+            ci = clauses.size();
+            clauses.push_back(lits);
+            learntFlag.push_back(0);
+            clauseActivity.push_back(0);
+        }
+        learntFlag[ci] = 1;
+        clauseActivity[ci] = claInc;
+        numLearnts++;
+        watches[lits[0]].push_back(ci);
+        watches[lits[1]].push_back(ci);
+        return ci;
+    }
+
+    void bumpClause(int ci) {
+        clauseActivity[ci] += claInc;
+        if (clauseActivity[ci] > 1e20) {
+            for (double& a : clauseActivity) a *= 1e-20;
+            claInc *= 1e-20;
+        }
+    }
+
+    // 删除活跃度较低的一半学习子句；作为当前赋值原因的子句和二元子句保留
+    void reduceLearnts() {
+        vector<int> candidates;
+        for (int ci = 0; ci < (int)clauses.size(); ci++) {
+            if (!learntFlag[ci] || clauses[ci].size() <= 2) continue;
+            int v = clauses[ci][0] >> 1;
+            if (reason[v] == ci && value(clauses[ci][0]) == 1) continue;
+            candidates.push_back(ci);
+        }
+        sort(candidates.begin(), candidates.end(), [&](const int a, const int b){
+            return clauseActivity[a] < clauseActivity[b];
+        });
+
+        vector<char> removed(clauses.size(), 0);
+        for (size_t k = 0; k < candidates.size() / 2; k++) {
+            int ci = candidates[k];
+            removed[ci] = 1;
+            learntFlag[ci] = 0;
+            vector<int>().swap(clauses[ci]);
+            freeSlots.push_back(ci);
+            numLearnts--;
+        }
+        for (vector<int>& ws : watches) {
+            ws.erase(remove_if(ws.begin(), ws.end(), [&](const int ci){ return removed[ci]; }), ws.end());
+        }
+    }
+
+    // 单元传播，返回冲突子句编号，无冲突返回-1
+    int propagate() {
+        while (qhead < (int)trail.size()) {
+            int falseLit = trail[qhead++] ^ 1;
+            vector<int>& ws = watches[falseLit];
+            size_t i = 0, j = 0;
+            while (i < ws.size()) {
+                int ci = ws[i++];
+                vector<int>& c = clauses[ci];
+                if (c[0] == falseLit) swap(c[0], c[1]);
+                if (value(c[0]) == 1) {
+                    ws[j++] = ci;
+                    continue;
+                }
+
+                bool moved = false;
+                for (size_t k = 2; k < c.size(); k++) {
+                    if (value(c[k]) != -1) {
+                        swap(c[1], c[k]);
+                        watches[c[1]].push_back(ci);
+                        moved = true;
+                        break;
+                    }
+                }
+                if (moved) continue;
+
+                ws[j++] = ci;
+                if (value(c[0]) == -1) {
+                    while (i < ws.size()) ws[j++] = ws[i++];
+                    ws.resize(j);
+                    return ci;
+                }
+                enqueue(c[0], ci);
+            }
+            ws.resize(j);
+        }
+        return -1;
+    }
+
+    // 1UIP冲突分析，得到学习子句（learnt[0]为回跳后被蕴含的文字）和回跳层
+    void analyze(int confl, vector<int>& learnt, int& backLevel) {
+        learnt.assign(1, -1);
+        int pathCount = 0, p = -1, idx = trail.size() - 1;
+        do {
+            if (learntFlag[confl]) bumpClause(confl);
+            const vector<int>& c = clauses[confl];
+            for (size_t j = (p == -1 ? 0 : 1); j < c.size(); j++) {
+                int v = c[j] >> 1;
+                if (seen[v] || level[v] == 0) continue;
+                seen[v] = 1;
+                bumpVar(v);
+                if (level[v] >= decisionLevel()) pathCount++;
+                else learnt.push_back(c[j]);
+            }
+            while (!seen[trail[idx] >> 1]) idx--;
+            p = trail[idx--];
+            confl = reason[p >> 1];
+            seen[p >> 1] = 0;
+            pathCount--;
+        } while (pathCount > 0);
+        learnt[0] = p ^ 1;
+
+        backLevel = 0;
+        for (size_t j = 1; j < learnt.size(); j++) {
+            seen[learnt[j] >> 1] = 0;
+            if (level[learnt[j] >> 1] > backLevel) {
+                backLevel = level[learnt[j] >> 1];
+                swap(learnt[1], learnt[j]);
+            }
+        }
+    }
+
+    static int luby(int i) {
+        int size = 1, seq = 0;
+        while (size < i + 1) {
+            seq++;
+            size = 2 * size + 1;
+        }
+        while (size - 1 != i) {
+            size = (size - 1) / 2;
+            seq--;
+            i %= size;
+        }
+        return 1 << seq;
+    }
+
+    // 返回1表示可满足，0表示不可满足，-1表示冲突数超过conflictBudget仍未得出结论（conflictBudget<0时不限）
+    int solve(long long conflictBudget) {
+        if (unsat || propagate() != -1) return 0;
+
+        vector<int> learnt;
+        int restarts = 0, conflicts = 0, limit = 100 * luby(0);
+        long long totalConflicts = 0;
+        double maxLearnts = max(2000.0, clauses.size() / 3.0);
+        while (true) {
+            int confl = propagate();
+            if (confl != -1) {
+                if (decisionLevel() == 0) return 0;
+                conflicts++;
+                totalConflicts++;
+                int backLevel;
+                analyze(confl, learnt, backLevel);
+                cancelUntil(backLevel);
+                if (learnt.size() == 1) {
+                    enqueue(learnt[0], -1);
+                } else {
+                    enqueue(learnt[0], addLearnt(learnt));
+                }
+                varInc /= 0.95;
+                claInc /= 0.999;
+                continue;
+            }
+
+            if (conflictBudget >= 0 && totalConflicts >= conflictBudget) return -1;
+            if (conflicts >= limit) {
+                conflicts = 0;
+                limit = 100 * luby(++restarts);
+                cancelUntil(0);
+            }
+            if (numLearnts - (int)trail.size() >= maxLearnts) {
+                reduceLearnts();
+                maxLearnts *= 1.1;
+            }
+
+            int next = -1;
+            while (!heap.empty()) {
+                int v = heapPop();
+                if (assigns[v] == 0) {
+                    next = v;
+                    break;
+                }
+            }
+            if (next == -1) return 1; // 所有变量已赋值
+            trailLim.push_back(trail.size());
+            enqueue(2 * next + (phase[next] ? 0 : 1), -1);
+        }
+    }
+};
+
+// 动态图的一次边更新
+struct EdgeUpdate {
+    int u, v;
+    bool insert; // true为加边，false为删边
+};
+
+// 加载后对节点重新编号的方式，使邻接表和各节点数组的访问更连续
+enum ReorderMode {
+    REORDER_NONE,   // 保持文件中的编号
+    REORDER_BFS,    // 广度优先顺序
+    REORDER_RCM,    // 逆Cuthill-McKee顺序
+    REORDER_DEGREE  // 按度从大到小
+};
+
 // 定义图结构体，用于图着色问题
 struct Graph {
     int Size; // 图的节点数
     vector<vector<int>> adj; // 邻接表，表示图的边
     vector<int> colors; // 每个节点的颜色
     int maxColors; // 最大可用颜色数
-    vector<vector<int>> available_color; // 记录每个节点可用的颜色
+    ColorTable available_color; // 记录每个节点可用的颜色
     vector<int> sorted_degree; // 按度排序的节点
     vector<int> degree; // 每个节点的度
+    vector<int> original_id; // 重编号后每个节点在原文件中的编号
+    vector<int> component_mark; // 划分连通分量或邻域时的访问标记
+    int component_stamp = 0; // 当前访问标记的编号
+    vector<int> elimination_rank; // 最小度消元顺序中的位次，分量计数时优先分支位次大的节点
 
     // 构造函数，初始化图结构
-    Graph(int n, int c) : Size(n), maxColors(c), adj(n + 1), colors(n + 1, -1), available_color(n + 1, vector<int>(c + 1, 0)), degree(n + 1, 0), sorted_degree(n + 1, 0) {
+    Graph(int n, int c) : Size(n), maxColors(c), adj(n + 1), colors(n + 1, -1), available_color(n + 1, c + 1), degree(n + 1, 0), sorted_degree(n + 1, 0), original_id(n + 1, 0) {
         for (int i = 1; i <= Size; i++) {
             available_color[i][0] = c;
             sorted_degree[i] = i;
+            original_id[i] = i;
         }
     }
 
@@ -34,6 +428,116 @@ struct Graph {
         degree[v]++;
     }
 
+    // 删除u、v之间的所有边（数据中可能有重边），返回删除的条数
+    int removeEdge(int u, int v) {
+        int before = adj[u].size();
+        adj[u].erase(remove(adj[u].begin(), adj[u].end(), v), adj[u].end());
+        int removed = before - adj[u].size();
+        if (u == v) { // 自环在邻接表中存了两份
+            degree[u] -= removed;
+            return removed / 2;
+        }
+        adj[v].erase(remove(adj[v].begin(), adj[v].end(), u), adj[v].end());
+        degree[u] -= removed;
+        degree[v] -= removed;
+        return removed;
+    }
+
+    // 按广度优先遍历生成新顺序；byDegree为真时按Cuthill-McKee规则从低度节点出发、邻居按度升序入队
+    vector<int> bfsOrder(bool byDegree) const {
+        vector<int> start(Size);
+        iota(start.begin(), start.end(), 1);
+        if (byDegree) {
+            stable_sort(start.begin(), start.end(), [&](const int i, const int j){
+                return degree[i] < degree[j];
+            });
+        }
+
+        vector<int> order;
+        vector<bool> visited(Size + 1, false);
+        order.reserve(Size);
+        for (int root : start) {
+            if (visited[root]) continue;
+            visited[root] = true;
+            order.push_back(root);
+            for (size_t head = order.size() - 1; head < order.size(); head++) {
+                vector<int> next;
+                for (int neighbor : adj[order[head]]) {
+                    if (visited[neighbor]) continue;
+                    visited[neighbor] = true;
+                    next.push_back(neighbor);
+                }
+                if (byDegree) {
+                    stable_sort(next.begin(), next.end(), [&](const int i, const int j){
+                        return degree[i] < degree[j];
+                    });
+                }
+                order.insert(order.end(), next.begin(), next.end());
+            }
+        }
+        return order;
+    }
+
+    // 返回按mode重新编号后的图，original_id记录新编号到原编号的映射
+    Graph relabel(ReorderMode mode) const {
+        vector<int> order; // order[k]为新编号k+1对应的当前节点
+        if (mode == REORDER_BFS) {
+            order = bfsOrder(false);
+        } else if (mode == REORDER_RCM) {
+            order = bfsOrder(true);
+            reverse(order.begin(), order.end());
+        } else {
+            order.resize(Size);
+            iota(order.begin(), order.end(), 1);
+            if (mode == REORDER_DEGREE) {
+                stable_sort(order.begin(), order.end(), [&](const int i, const int j){
+                    return degree[i] > degree[j];
+                });
+            }
+        }
+
+        vector<int> new_id(Size + 1, 0);
+        for (int k = 0; k < Size; k++) new_id[order[k]] = k + 1;
+
+        Graph g(Size, maxColors);
+        for (int i = 1; i <= Size; i++) {
+            int u = new_id[i];
+            g.adj[u].reserve(adj[i].size());
+            for (int neighbor : adj[i]) g.adj[u].push_back(new_id[neighbor]);
+            sort(g.adj[u].begin(), g.adj[u].end());
+            g.degree[u] = degree[i];
+            g.colors[u] = colors[i];
+            copy(available_color[i], available_color[i] + maxColors + 1, g.available_color[u]);
+            g.original_id[u] = original_id[i];
+        }
+        return g;
+    }
+
+    // 清空所有着色和可用颜色记录，复用已分配的内存，供同一张图上多次求解
+    void reset() {
+        fill(colors.begin(), colors.end(), -1);
+        fill(available_color.cells.begin(), available_color.cells.end(), 0);
+        for (int i = 1; i <= Size; i++) {
+            available_color[i][0] = maxColors;
+            sorted_degree[i] = i;
+        }
+    }
+
+    // MRV+DH系列求解时首个固定为颜色1的节点：原文件中的43号节点，重编号后按original_id找到它的新编号
+    int seedNode() const {
+        for (int i = 1; i <= Size; i++) {
+            if (original_id[i] == 43) return i;
+        }
+        return 1; // 节点数不足43时取1号节点
+    }
+
+    // 按原文件编号返回当前着色方案
+    vector<int> originalColors() const {
+        vector<int> result(Size + 1, -1);
+        for (int i = 1; i <= Size; i++) result[original_id[i]] = colors[i];
+        return result;
+    }
+
     bool is_safe(int num, int color) {
         for (int neighbor : adj[num]) {
             if (colors[neighbor] == color) return false;
@@ -255,8 +759,9 @@ struct Graph {
 
     // MRV+DH优化
     bool MRV_DH_backtrack() {
-        updateMRV(43, 1);
-        colors[43] = 1;
+        int seed = seedNode();
+        updateMRV(seed, 1);
+        colors[seed] = 1;
         return __MRV_DH_backtrack();
     }
 
@@ -282,8 +787,9 @@ struct Graph {
 
     // MRV+DH优化（统计所有解的总数）
     int MRV_DH_backtrack_count() {
-        updateMRV(43, 1);
-        colors[43] = 1;
+        int seed = seedNode();
+        updateMRV(seed, 1);
+        colors[seed] = 1;
         int ans = 0;
         __MRV_DH_backtrack_count(ans);
         return ans;
@@ -366,8 +872,9 @@ struct Graph {
 
     // MRV+DH+向前探测优化
     bool MRV_DH_FC_backtrack() {
-        updateMRV(43, 1);
-        colors[43] = 1;
+        int seed = seedNode();
+        updateMRV(seed, 1);
+        colors[seed] = 1;
         return __MRV_DH_FC_backtrack();
     }
 
@@ -397,8 +904,9 @@ struct Graph {
 
     // MRV+DH+向前探测优化（统计所有解的总数）
     int MRV_DH_FC_backtrack_count() {
-        updateMRV(43, 1);
-        colors[43] = 1;
+        int seed = seedNode();
+        updateMRV(seed, 1);
+        colors[seed] = 1;
         int ans = 0;
         __MRV_DH_FC_backtrack_count(ans);
         return ans * maxColors;
@@ -426,8 +934,9 @@ struct Graph {
     }
 
     bool MRV_DH_FC_CC_backtrack() {
-        updateMRV(43, 1);
-        colors[43] = 1;
+        int seed = seedNode();
+        updateMRV(seed, 1);
+        colors[seed] = 1;
         return __MRV_DH_FC_CC_backtrack();
     }
 
@@ -457,13 +966,332 @@ struct Graph {
 
     // MRV+DH+向前探测优化+颜色轮询（统计所有解的总数）
     int MRV_DH_FC_CC_backtrack_count() {
-        updateMRV(43, 1);
-        colors[43] = 1;
+        int seed = seedNode();
+        updateMRV(seed, 1);
+        colors[seed] = 1;
         int ans = 0;
         __MRV_DH_FC_CC_backtrack_count(ans);
         return ans * maxColors;
     }
 
+    // 按最小度启发式对未填色节点做消元，越晚消去的节点越接近树分解的根
+    void computeEliminationOrder() {
+        elimination_rank.assign(Size + 1, 0);
+        vector<set<int>> fill(Size + 1); // 消元过程中的邻接关系（含填充边）
+        set<pair<int, int>> order; // (当前度, 节点)
+        for (int i = 1; i <= Size; i++) {
+            if (colors[i] != -1) continue;
+            for (int neighbor : adj[i]) {
+                if (neighbor != i && colors[neighbor] == -1) fill[i].insert(neighbor);
+            }
+        }
+        for (int i = 1; i <= Size; i++) {
+            if (colors[i] == -1) order.insert({(int)fill[i].size(), i});
+        }
+
+        int rank = 0;
+        while (!order.empty()) {
+            int node = order.begin()->second;
+            order.erase(order.begin());
+            elimination_rank[node] = ++rank;
+
+            vector<int> neighbors(fill[node].begin(), fill[node].end());
+            for (int v : neighbors) {
+                order.erase({(int)fill[v].size(), v});
+                fill[v].erase(node);
+            }
+            for (size_t a = 0; a < neighbors.size(); a++) {
+                for (size_t b = a + 1; b < neighbors.size(); b++) {
+                    fill[neighbors[a]].insert(neighbors[b]);
+                    fill[neighbors[b]].insert(neighbors[a]);
+                }
+            }
+            for (int v : neighbors) order.insert({(int)fill[v].size(), v});
+            fill[node].clear();
+        }
+    }
+
+    // 将nodes中未填色的节点按未填色邻居划分为若干连通分量
+    void splitComponents(const vector<int>& nodes, vector<vector<int>>& parts) {
+        component_stamp++;
+        for (int start : nodes) {
+            if (colors[start] != -1 || component_mark[start] == component_stamp) continue;
+            parts.emplace_back();
+            vector<int>& part = parts.back();
+            component_mark[start] = component_stamp;
+            part.push_back(start);
+            for (size_t head = 0; head < part.size(); head++) {
+                for (int neighbor : adj[part[head]]) {
+                    if (colors[neighbor] != -1 || component_mark[neighbor] == component_stamp) continue;
+                    component_mark[neighbor] = component_stamp;
+                    part.push_back(neighbor);
+                }
+            }
+        }
+    }
+
+    // 分量的缓存键：有序节点编号，加上每种颜色在分量内"哪些节点可用"的位串。
+    // 颜色之间可以任意互换而不改变计数，因此把各颜色的位串排序后再拼接，互为颜色置换的分量共用同一个键
+    string componentKey(const vector<int>& comp) {
+        size_t bytes = (comp.size() + 7) / 8;
+        vector<string> signatures(maxColors, string(bytes, '\0'));
+        for (size_t k = 0; k < comp.size(); k++) {
+            for (int color = 1; color <= maxColors; color++) {
+                if (available_color[comp[k]][color] == 0) signatures[color - 1][k / 8] |= char(1 << (k % 8));
+            }
+        }
+        sort(signatures.begin(), signatures.end());
+
+        string key;
+        key.reserve(comp.size() * sizeof(int) + maxColors * bytes);
+        for (int node : comp) key.append(reinterpret_cast<const char*>(&node), sizeof(int));
+        for (const string& signature : signatures) key += signature;
+        return key;
+    }
+
+    long double __component_count(vector<int>& comp, ComponentCache& cache) {
+        if (comp.size() == 1) return available_color[comp[0]][0]; // 孤立节点
+
+        sort(comp.begin(), comp.end());
+        string key = componentKey(comp);
+        long double total = 0;
+        if (cache.get(key, total)) return total;
+
+        // 优先分支消元顺序中最靠后的节点，使剩余部分尽快分裂
+        int node = comp[0];
+        for (int v : comp) {
+            if (elimination_rank[v] > elimination_rank[node]) node = v;
+        }
+
+        for (int color = 1; color <= maxColors; color++) {
+            if (available_color[node][color] == 1) continue;
+            bool feasible = updateMRV(node, color);
+            colors[node] = color;
+            if (feasible) {
+                vector<vector<int>> parts;
+                splitComponents(comp, parts);
+                long double product = 1;
+                for (vector<int>& part : parts) {
+                    product *= __component_count(part, cache);
+                    if (product == 0) break;
+                }
+                total += product;
+            }
+            colors[node] = -1;
+            unupdateMRV(node, color);
+        }
+
+        cache.put(key, total);
+        return total;
+    }
+
+    // 分量分解+缓存计数（统计所有解的总数），各连通分量独立计数后相乘
+    long double component_count(size_t cacheBytes = size_t(256) << 20) {
+        ComponentCache cache(cacheBytes);
+        component_mark.assign(Size + 1, 0);
+        component_stamp = 0;
+        computeEliminationOrder();
+
+        vector<int> nodes;
+        for (int i = 1; i <= Size; i++) {
+            if (colors[i] != -1) continue;
+            if (available_color[i][0] == 0) return 0;
+            nodes.push_back(i);
+        }
+
+        vector<vector<int>> parts;
+        splitComponents(nodes, parts);
+        long double ans = 1;
+        for (vector<int>& part : parts) {
+            ans *= __component_count(part, cache);
+            if (ans == 0) break;
+        }
+        return ans;
+    }
+
+    // SAT编码+CDCL：变量x(v,c)表示节点v取颜色c，每个节点至少取一种颜色，相邻节点不取同一种颜色；
+    // 贪心找一个团并固定其颜色，以打破颜色对称性。
+    // 返回1表示找到着色，0表示k种颜色不可行，-1表示冲突数超过conflictBudget（<0为不限）仍未得出结论
+    int SAT_solve(long long conflictBudget = 50000) {
+        auto var = [&](int node, int color) { return (node - 1) * maxColors + (color - 1); };
+        SatSolver solver(Size * maxColors);
+
+        for (int i = 1; i <= Size; i++) {
+            vector<int> clause;
+            for (int color = 1; color <= maxColors; color++) clause.push_back(2 * var(i, color));
+            solver.addClause(clause);
+        }
+
+        vector<int> mark(Size + 1, 0);
+        for (int i = 1; i <= Size; i++) {
+            for (int neighbor : adj[i]) {
+                if (neighbor <= i || mark[neighbor] == i) continue; // 每条边只编码一次
+                mark[neighbor] = i;
+                for (int color = 1; color <= maxColors; color++) {
+                    solver.addClause({2 * var(i, color) + 1, 2 * var(neighbor, color) + 1});
+                }
+            }
+        }
+
+        // 从度最大的节点开始贪心扩展团，团内节点依次固定为颜色1、2、...
+        vector<int> clique;
+        vector<int> candidates(Size);
+        iota(candidates.begin(), candidates.end(), 1);
+        while (!candidates.empty()) {
+            int node = *max_element(candidates.begin(), candidates.end(), [&](const int i, const int j){
+                return degree[i] < degree[j];
+            });
+            clique.push_back(node);
+            vector<int> next;
+            for (int neighbor : adj[node]) {
+                if (find(candidates.begin(), candidates.end(), neighbor) != candidates.end() &&
+                    find(next.begin(), next.end(), neighbor) == next.end()) {
+                    next.push_back(neighbor);
+                }
+            }
+            candidates = next;
+        }
+        if ((int)clique.size() > maxColors) return 0;
+        for (size_t k = 0; k < clique.size(); k++) solver.addClause({2 * var(clique[k], k + 1)});
+
+        int result = solver.solve(conflictBudget);
+        if (result != 1) return result;
+        for (int i = 1; i <= Size; i++) {
+            for (int color = 1; color <= maxColors; color++) {
+                if (solver.assigns[var(i, color)] == 1) {
+                    colors[i] = color;
+                    break;
+                }
+            }
+        }
+        return 1;
+    }
+
+    // 只在region内的未填色节点上回溯，region外的节点颜色固定；budget为剩余可扩展的节点数，-1表示不限
+    bool __repair_backtrack(const vector<int>& region, int& budget) {
+        int node = -1;
+        for (int v : region) {
+            if (colors[v] != -1) continue;
+            if (node == -1 || available_color[v][0] < available_color[node][0] ||
+                (available_color[v][0] == available_color[node][0] && degree[v] > degree[node])) {
+                node = v;
+            }
+        }
+        if (node == -1) return true;
+        if (available_color[node][0] == 0) return false;
+        if (budget == 0) return false;
+        if (budget > 0) budget--;
+
+        for (int color = 1; color <= maxColors; color++) {
+            if (available_color[node][color] == 1) continue;
+            bool feasible = updateMRV(node, color);
+            colors[node] = color;
+            if (feasible && __repair_backtrack(region, budget)) return true;
+            colors[node] = -1;
+            unupdateMRV(node, color);
+            if (budget == 0) return false;
+        }
+        return false;
+    }
+
+    // 按region外已填色的邻居重新计算region内未填色节点的可用颜色
+    void recomputeDomains(const vector<int>& region) {
+        for (int v : region) {
+            if (colors[v] != -1) continue;
+            fill(available_color[v], available_color[v] + maxColors + 1, 0);
+            available_color[v][0] = maxColors;
+            for (int neighbor : adj[v]) {
+                int color = colors[neighbor];
+                if (color == -1 || available_color[v][color] == 1) continue;
+                available_color[v][color] = 1;
+                available_color[v][0]--;
+            }
+        }
+    }
+
+    // 在当前完整合法的着色上应用一批边更新，只修复新产生的冲突：
+    // 先对冲突节点贪心换色，失败时在半径1..maxRadius的邻域内做有限回溯，仍失败才用SAT_solve整体重解。
+    // 返回false时（新图在冲突上限内无解或未能判定）撤销本批更新并恢复原着色，图仍可继续使用
+    bool applyEdgeUpdates(const vector<EdgeUpdate>& updates, int maxRadius = 2, int budget = 100000, long long conflictBudget = 50000) {
+        vector<pair<EdgeUpdate, int>> applied; // 实际生效的更新及其涉及的边数，用于撤销
+        vector<int> conflicts;
+        for (const EdgeUpdate& e : updates) {
+            if (!e.insert) {
+                int removed = removeEdge(e.u, e.v); // 删边不会产生冲突
+                if (removed > 0) applied.push_back({e, removed});
+                continue;
+            }
+            if (e.u == e.v || find(adj[e.u].begin(), adj[e.u].end(), e.v) != adj[e.u].end()) continue; // 不加自环和重边
+            addEdge(e.u, e.v);
+            applied.push_back({e, 1});
+            if (colors[e.u] == -1) conflicts.push_back(e.u);
+            if (colors[e.v] == -1) conflicts.push_back(e.v);
+            if (colors[e.u] != -1 && colors[e.u] == colors[e.v]) {
+                conflicts.push_back(degree[e.u] < degree[e.v] ? e.u : e.v);
+            }
+        }
+        sort(conflicts.begin(), conflicts.end());
+        conflicts.erase(unique(conflicts.begin(), conflicts.end()), conflicts.end());
+        vector<int> original(conflicts.size()); // 冲突节点的原颜色，其余节点在失败时不会被改动
+        for (size_t i = 0; i < conflicts.size(); i++) original[i] = colors[conflicts[i]];
+
+        // 冲突节点先全部取消着色，再逐个选择邻居未使用的颜色
+        for (int v : conflicts) colors[v] = -1;
+        vector<int> hard;
+        for (int v : conflicts) {
+            for (int color = 1; color <= maxColors; color++) {
+                if (is_safe(v, color)) {
+                    colors[v] = color;
+                    break;
+                }
+            }
+            if (colors[v] == -1) hard.push_back(v);
+        }
+        if (hard.empty()) return true;
+
+        // 在冲突节点的邻域内回溯，逐步扩大半径
+        if ((int)component_mark.size() != Size + 1) component_mark.assign(Size + 1, 0);
+        for (int radius = 1; radius <= maxRadius; radius++) {
+            component_stamp++;
+            vector<int> region = hard, dist(hard.size(), 0);
+            for (int v : hard) component_mark[v] = component_stamp;
+            for (size_t head = 0; head < region.size(); head++) {
+                if (dist[head] == radius) continue;
+                for (int neighbor : adj[region[head]]) {
+                    if (component_mark[neighbor] == component_stamp) continue;
+                    component_mark[neighbor] = component_stamp;
+                    region.push_back(neighbor);
+                    dist.push_back(dist[head] + 1);
+                }
+            }
+
+            vector<int> saved(region.size());
+            for (size_t i = 0; i < region.size(); i++) {
+                saved[i] = colors[region[i]];
+                colors[region[i]] = -1;
+            }
+            recomputeDomains(region);
+            int remaining = budget;
+            if (__repair_backtrack(region, remaining)) return true;
+            for (size_t i = 0; i < region.size(); i++) colors[region[i]] = saved[i];
+            for (int v : hard) colors[v] = -1;
+        }
+
+        // 局部修复失败，整体重新求解；SAT_solve只在成功时改写colors
+        if (SAT_solve(conflictBudget) == 1) return true;
+
+        // 仍失败：按相反顺序撤销本批更新，恢复冲突节点的原颜色
+        for (int i = (int)applied.size() - 1; i >= 0; i--) {
+            const EdgeUpdate& e = applied[i].first;
+            if (e.insert) {
+                removeEdge(e.u, e.v);
+            } else {
+                for (int k = 0; k < applied[i].second; k++) addEdge(e.u, e.v);
+            }
+        }
+        for (size_t i = 0; i < conflicts.size(); i++) colors[conflicts[i]] = original[i];
+        return false;
+    }
 
     // MRV策略：选择颜色最少的未填色节点
     int selectMRV() {
@@ -497,7 +1325,7 @@ struct Graph {
     void unupdateMRV(int node, int color) {
         for (int neighbor : adj[node]) {
             if (colors[neighbor] != -1) continue;
-            if (is_safe(neighbor, color)) {
+            if (available_color[neighbor][color] == 1 && is_safe(neighbor, color)) { // 重边只恢复一次
                 available_color[neighbor][color] = 0;
                 available_color[neighbor][0] += 1;
             }
@@ -526,7 +1354,19 @@ struct Graph {
 
 };
 
-void testAlgorithm(const string& filename, int maxColor) {
+// 按原文件编号检查着色是否合法：每个节点都已着色且每条边两端颜色不同
+bool checkColoring(const vector<int>& colors, const vector<pair<int, int>>& edges) {
+    for (size_t i = 1; i < colors.size(); i++) {
+        if (colors[i] < 1) return false;
+    }
+    for (const pair<int, int>& e : edges) {
+        if (colors[e.first] == colors[e.second]) return false;
+    }
+    return true;
+}
+
+// countComponents为真时额外运行分量分解+缓存计数，只适合稀疏图
+void testAlgorithm(const string& filename, int maxColor, ReorderMode mode = REORDER_NONE, bool countComponents = false) {
     ifstream file(filename);
     if (!file.is_open()) {
         cout << "无法打开文件: " << filename << endl;
@@ -536,6 +1376,7 @@ void testAlgorithm(const string& filename, int maxColor) {
     string line;
     int nodes = 0, edges = 0;
     Graph graph(0, 0);
+    vector<pair<int, int>> fileEdges; // 原文件中的边，用于检查映射回原编号后的着色
 
     while (getline(file, line)) {
         if (line[0] == 'p') {
@@ -545,6 +1386,7 @@ void testAlgorithm(const string& filename, int maxColor) {
             int u, v;
             sscanf(line.c_str(), "e %d %d", &u, &v);
             graph.addEdge(u, v);
+            fileEdges.push_back({u, v});
         }
     }
 
@@ -552,8 +1394,13 @@ void testAlgorithm(const string& filename, int maxColor) {
 
     cout << "测试文件: " << filename << ", 节点数: " << nodes << ", 边数: " << edges << endl;
 
+    if (mode != REORDER_NONE) {
+        graph = graph.relabel(mode); // 重编号节点以提高缓存命中率
+        const char* names[] = {"无", "BFS", "RCM", "按度降序"};
+        cout << "节点重编号: " << names[mode] << "（选点时同分按新编号取舍，搜索顺序与原编号不同）" << endl;
+    }
 
-    Graph g = graph; // 复制图
+    Graph g = graph; // 复制图，之后每次求解前用reset()清空状态
     cout << "颜色数: " << maxColor << endl;
 
     auto start = chrono::high_resolution_clock::now();
@@ -570,7 +1417,7 @@ void testAlgorithm(const string& filename, int maxColor) {
     // if (success) {
     //     cout << "成功，用时 " << timeTaken << " 微秒" << endl;
 
-    //     g = graph;
+    //     g.reset();
     //     start = chrono::high_resolution_clock::now();
     //     int count = g.simple_backtrack_count(1);
     //     end = chrono::high_resolution_clock::now();
@@ -581,7 +1428,7 @@ void testAlgorithm(const string& filename, int maxColor) {
     // }
 
     // // MRV优化
-    // g = graph;
+    // g.reset();
     // start = chrono::high_resolution_clock::now();
     // success = g.MRV_backtrack();
     // end = chrono::high_resolution_clock::now();
@@ -590,7 +1437,7 @@ void testAlgorithm(const string& filename, int maxColor) {
     // if (success) {
     //     cout << "成功，用时 " << timeTaken << " 微秒" << endl;
 
-    //     g = graph;
+    //     g.reset();
     //     start = chrono::high_resolution_clock::now();
     //     int count = g.MRV_backtrack_count();
     //     end = chrono::high_resolution_clock::now();
@@ -601,7 +1448,7 @@ void testAlgorithm(const string& filename, int maxColor) {
     // }
 
     // // MRV+颜色轮询优化
-    // g = graph;
+    // g.reset();
     // start = chrono::high_resolution_clock::now();
     // int count = g.MRV_CC_backtrack_count();
     // end = chrono::high_resolution_clock::now();
@@ -609,7 +1456,7 @@ void testAlgorithm(const string& filename, int maxColor) {
     // cout << "MRV+颜色轮询优化(总数): " << count << ", 用时 " << timeTaken << " 微秒" << endl;
 
     // // DH优化 
-    // g = graph;
+    // g.reset();
     // start = chrono::high_resolution_clock::now();
     // success = g.DH_backtrack(1);
     // end = chrono::high_resolution_clock::now();
@@ -618,7 +1465,7 @@ void testAlgorithm(const string& filename, int maxColor) {
     // if (success) {
     //     cout << "成功，用时 " << timeTaken << " 微秒" << endl;
 
-    //     g = graph;
+    //     g.reset();
     //     start = chrono::high_resolution_clock::now();
     //     int count = g.DH_backtrack_count(1);
     //     end = chrono::high_resolution_clock::now();
@@ -629,7 +1476,7 @@ void testAlgorithm(const string& filename, int maxColor) {
     // }
 
     // // DH+颜色轮询优化
-    // g = graph;
+    // g.reset();
     // start = chrono::high_resolution_clock::now();
     // int count01 = g.DH_CC_backtrack_count(1);
     // end = chrono::high_resolution_clock::now();
@@ -637,7 +1484,7 @@ void testAlgorithm(const string& filename, int maxColor) {
     // cout << "DH+颜色轮询优化(总数): " << count01 << ", 用时 " << timeTaken << " 微秒" << endl;
 
     // MRV+DH优化
-    g = graph;
+    g.reset();
     start = chrono::high_resolution_clock::now();
     success = g.MRV_DH_backtrack();
     end = chrono::high_resolution_clock::now();
@@ -645,9 +1492,9 @@ void testAlgorithm(const string& filename, int maxColor) {
     timeTaken = chrono::duration_cast<chrono::microseconds>(end - start).count();
     cout << "MRV+DH优化: ";
     if (success) {
-        cout << "成功，用时 " << timeTaken << " 微秒" << endl;
+        cout << "成功，用时 " << timeTaken << " 微秒，着色" << (checkColoring(g.originalColors(), fileEdges) ? "合法" : "不合法") << endl;
 
-        g = graph;
+        g.reset();
         start = chrono::high_resolution_clock::now();
         int count = g.MRV_DH_backtrack_count();
         end = chrono::high_resolution_clock::now();
@@ -658,7 +1505,7 @@ void testAlgorithm(const string& filename, int maxColor) {
     }
 
     // // DH+向前探测优化
-    // g = graph;
+    // g.reset();
     // start = chrono::high_resolution_clock::now();
     // success = g.DH_FC_backtrack(1);
     // end = chrono::high_resolution_clock::now();
@@ -668,7 +1515,7 @@ void testAlgorithm(const string& filename, int maxColor) {
     // if (success) {
     //     cout << "成功，用时 " << timeTaken << " 微秒" << endl;
 
-    //     g = graph;
+    //     g.reset();
     //     start = chrono::high_resolution_clock::now();
     //     int count = g.DH_FC_backtrack_count(1);
     //     end = chrono::high_resolution_clock::now();
@@ -679,7 +1526,7 @@ void testAlgorithm(const string& filename, int maxColor) {
     // }
 
     // MRV+DH+向前探测优化
-    g = graph;
+    g.reset();
     start = chrono::high_resolution_clock::now();
     success = g.MRV_DH_FC_backtrack();
     end = chrono::high_resolution_clock::now();
@@ -687,9 +1534,9 @@ void testAlgorithm(const string& filename, int maxColor) {
     timeTaken = chrono::duration_cast<chrono::microseconds>(end - start).count();
     cout << "MRV+DH+向前探测优化: ";
     if (success) {
-        cout << "成功，用时 " << timeTaken << " 微秒" << endl;
+        cout << "成功，用时 " << timeTaken << " 微秒，着色" << (checkColoring(g.originalColors(), fileEdges) ? "合法" : "不合法") << endl;
 
-        g = graph;
+        g.reset();
         start = chrono::high_resolution_clock::now();
         int count = g.MRV_DH_FC_backtrack_count();
         end = chrono::high_resolution_clock::now();
@@ -700,7 +1547,7 @@ void testAlgorithm(const string& filename, int maxColor) {
     }
 
     // MRV+DH+向前探测优化+颜色轮询
-    g = graph;
+    g.reset();
     start = chrono::high_resolution_clock::now();
     success = g.MRV_DH_FC_CC_backtrack();
     end = chrono::high_resolution_clock::now();
@@ -708,9 +1555,9 @@ void testAlgorithm(const string& filename, int maxColor) {
     timeTaken = chrono::duration_cast<chrono::microseconds>(end - start).count();
     cout << "MRV+DH+向前探测优化+颜色轮询: ";
     if (success) {
-        cout << "成功，用时 " << timeTaken << " 微秒" << endl;
+        cout << "成功，用时 " << timeTaken << " 微秒，着色" << (checkColoring(g.originalColors(), fileEdges) ? "合法" : "不合法") << endl;
 
-        g = graph;
+        g.reset();
         start = chrono::high_resolution_clock::now();
         int count = g.MRV_DH_FC_CC_backtrack_count();
         end = chrono::high_resolution_clock::now();
@@ -720,6 +1567,55 @@ void testAlgorithm(const string& filename, int maxColor) {
         cout << "失败，用时 " << timeTaken << " 微秒" << endl;
     }
 
+    // SAT编码+CDCL
+    g.reset();
+    start = chrono::high_resolution_clock::now();
+    int result = g.SAT_solve();
+    end = chrono::high_resolution_clock::now();
+
+    timeTaken = chrono::duration_cast<chrono::microseconds>(end - start).count();
+    cout << "SAT编码+CDCL: ";
+    if (result == 1) {
+        cout << "成功，用时 " << timeTaken << " 微秒，着色" << (checkColoring(g.originalColors(), fileEdges) ? "合法" : "不合法") << endl;
+    } else if (result == 0) {
+        cout << "失败，用时 " << timeTaken << " 微秒" << endl;
+    } else {
+        cout << "未知（超出冲突上限），用时 " << timeTaken << " 微秒" << endl;
+    }
+
+    // 分量分解+缓存计数（适用于稀疏图）
+    if (countComponents) {
+        g.reset();
+        start = chrono::high_resolution_clock::now();
+        long double total = g.component_count();
+        end = chrono::high_resolution_clock::now();
+        timeTaken = chrono::duration_cast<chrono::microseconds>(end - start).count();
+        cout << "分量分解+缓存计数(总数): " << total << ", 用时 " << timeTaken << " 微秒" << endl;
+    }
+
+    // 动态图增量修复：先求出一个着色，再逐批随机加10条边、删5条边，每批只修复新产生的冲突
+    g.reset();
+    if (g.SAT_solve() == 1) {
+        srand(2024);
+        for (int batch = 1; batch <= 10; batch++) {
+            vector<EdgeUpdate> updates;
+            for (int k = 0; k < 10; k++) updates.push_back({rand() % nodes + 1, rand() % nodes + 1, true});
+            for (int k = 0; k < 5; k++) {
+                int u = rand() % nodes + 1;
+                if (!g.adj[u].empty()) updates.push_back({u, g.adj[u][0], false});
+            }
+            start = chrono::high_resolution_clock::now();
+            success = g.applyEdgeUpdates(updates);
+            end = chrono::high_resolution_clock::now();
+            timeTaken = chrono::duration_cast<chrono::microseconds>(end - start).count();
+            bool valid = true;
+            for (int i = 1; i <= nodes; i++) {
+                if (g.colors[i] < 1 || !g.is_safe(i, g.colors[i])) valid = false;
+            }
+            cout << "增量修复(第" << batch << "批): " << (success ? "成功" : "失败，已撤销本批更新") << "，用时 " << timeTaken << " 微秒，着色" << (valid ? "合法" : "不合法") << endl;
+        }
+    }
+
     cout << "----------------------------------------" << endl;
     
 }
@@ -730,7 +1626,7 @@ int main() {
     // testAlgorithm("le450_25a.col", 25);
     // testAlgorithm("le450_5a.col", 5);
     testAlgorithm("le450_15b.col", 15);
-    // testAlgorithm("300_250.col",  6);
+    testAlgorithm("300_250.col",  6, REORDER_NONE, true);
     // testAlgorithm("300_500.col",  6);
     // testAlgorithm("300_750.col",  6);
     // testAlgorithm("300_1000.col", 6);
@@ -748,7 +1644,8 @@ int main() {
     //testAlgorithm("1250_6250.col",  6);
     //testAlgorithm("1500_7500.col",  6);
     //testAlgorithm("1750_8750.col",  6);
-    //testAlgorithm("2000_10000.col", 6);
+    testAlgorithm("2000_10000.col", 6);
+    testAlgorithm("2000_10000.col", 6, REORDER_RCM);
     //testAlgorithm("2250_11250.col", 6);
     //testAlgorithm("2500_12500.col", 6);
 